@@ -28,6 +28,22 @@ private:
     uint64_t current_direction;
     unsigned char jump_offsets[pack_size<Funcs...>][OFFSET_];
 
+    #ifdef DEFERRED_MODE
+    /**
+     * Direction requested through set_direction but not yet patched in. Kept on
+     * its own (padded) cache line so writers (possibly on other threads) do not falsely
+     * share with the fields read during sync.
+    */
+
+    struct alignas(CACHE_LINE_SIZE_) padded_direction {
+        std::atomic<uint64_t> value;
+    };
+
+    static_assert(sizeof(padded_direction) == CACHE_LINE_SIZE_);
+
+    padded_direction pending_direction;
+    #endif
+
     #if defined(GCC_BUILD_BRANCH) || defined(CLANG_BUILD_BRANCH)
 
     /**
@@ -78,15 +94,20 @@ public:
         #ifdef SAFE_MODE
         change_permissions(this->bytecode_to_edit, permissions::READ_EXECUTE);
         #endif
+        uint64_t initial_direction = 0;
         if (pack.size() == 2) {
             std::swap(jump_offsets[0], jump_offsets[1]);
-            set_direction(1);
-        } else
-            set_direction(0);
+            initial_direction = 1;
+        }
+        _patch_direction(initial_direction);
+        #ifdef DEFERRED_MODE
+        pending_direction.value.store(initial_direction, std::memory_order_relaxed);
+        #endif
     }
 
+private:
     #ifndef SAFE_MODE
-    void set_direction(const uint64_t condition) {
+    void _patch_direction(const uint64_t condition) {
 
         /**
          * Args: a runtime condition which can either be a bool or int.
@@ -109,7 +130,7 @@ public:
     }
 
     #else
-    void set_direction(const uint64_t condition) {
+    void _patch_direction(const uint64_t condition) {
 
         /**
          * Args: a runtime condition which can either be a bool or int.
@@ -131,6 +152,63 @@ public:
         }
     }
     #endif
+
+public:
+    #ifndef DEFERRED_MODE
+    void set_direction(const uint64_t condition) {
+
+        /**
+         * Args: a runtime condition which can either be a bool or int.
+         * 
+         * Patches the branch direction immediately, see _patch_direction.
+        */
+
+        _patch_direction(condition);
+    }
+
+    #else
+    void set_direction(const uint64_t condition) {
+
+        /**
+         * Args: a runtime condition which can either be a bool or int.
+         * 
+         * Records the desired branch direction without touching any assembly.
+         * The patch is deferred until the next call to sync, so any number of
+         * flips in between collapse into at most one SMC penalty. This can be
+         * activated using the -DDEFERRED_MODE flag.
+         * 
+         * Cost: a single relaxed store.
+        */
+
+        pending_direction.value.store(condition, std::memory_order_relaxed);
+    }
+
+    void sync() {
+
+        /**
+         * Applies the most recently requested direction. Intended to be called
+         * at an explicit commit point, such as the top of an event loop. No
+         * assembly modification takes place if the pending direction matches
+         * the current one.
+        */
+
+        _patch_direction(pending_direction.value.load(std::memory_order_relaxed));
+    }
+
+    template <typename... Args>
+    decltype(auto) synced_branch(Args&&... args) {
+
+        /**
+         * Args: arguments forwarded to the branch method.
+         * 
+         * Calls sync before executing the branch, for callers that would rather
+         * commit pending directions lazily at the point of branching.
+        */
+
+        sync();
+        return this->branch(std::forward<Args>(args)...);
+    }
+    #endif
 };
 
 
@@ -0,0 +1,102 @@
+#ifndef BRANCH_CONTROL_PLANE_HPP
+#define BRANCH_CONTROL_PLANE_HPP
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include "branch.hpp"
+#include "builds/branch_control.hpp"
+
+
+class BranchControlPlane {
+
+    /**
+     * BranchControlPlane exposes registered BranchChanger instances by name
+     * through a POSIX shared memory segment, so that their directions can be
+     * flipped from another process (see tools/branch_ctl.cpp). Requests are
+     * applied through set_direction, either by a watcher thread or by calling
+     * poll explicitly, so the hot path remains a patched jump.
+     * 
+     * Without DEFERRED_MODE, set_direction patches code and updates the
+     * current direction without synchronisation. An instance registered with
+     * a running watcher must then only be flipped through the control plane,
+     * or the owning thread must call poll itself instead of starting a
+     * watcher. Under DEFERRED_MODE the watcher only stores the pending
+     * direction atomically, and the owning thread is free to call
+     * set_direction and sync as usual.
+    */
+
+private:
+    using applier = void(*)(void*, const uint64_t);
+
+    struct handle {
+        control_entry* entry;
+        uint64_t last_sequence;
+        uint64_t directions;
+        void* branch;
+        applier apply;
+    };
+
+    std::string segment_name;
+    control_segment* segment;
+    std::vector<handle> handles;
+    std::mutex handles_lock;
+    std::atomic<bool> running;
+    std::thread watcher;
+
+    template <typename Branch>
+    static void _apply_direction(void* branch, const uint64_t condition) {
+        static_cast<Branch*>(branch)->set_direction(condition);
+    }
+
+    void _register(const std::string& name, const uint64_t directions,
+                   void* branch, applier apply);
+    void _watch(const std::chrono::microseconds interval);
+
+public:
+    explicit BranchControlPlane(const std::string& name);
+    BranchControlPlane(const BranchControlPlane&) = delete;
+    BranchControlPlane& operator=(const BranchControlPlane&) = delete;
+    ~BranchControlPlane();
+
+    template <typename... Funcs>
+    void register_branch(const std::string& name, BranchChanger<Funcs...>& branch) {
+
+        /**
+         * Args: name the branch is exposed under and the instance to control.
+         * 
+         * Publishes the branch in the shared memory segment. The instance must
+         * outlive the control plane, or the watcher must be stopped first.
+        */
+
+        _register(name, pack_size<Funcs...>, &branch,
+                  &_apply_direction<BranchChanger<Funcs...>>);
+    }
+
+    void poll();
+
+        /**
+         * Applies any outstanding requests through set_direction. Requests for
+         * directions out of bounds are ignored. Bounds are checked against the
+         * number of branches recorded at registration, never against the
+         * shared segment, which any process of the same user may write to.
+        */
+
+    void start(const std::chrono::microseconds interval = std::chrono::microseconds(10));
+
+        /**
+         * Args: time the watcher sleeps between polls.
+         * 
+         * Spawns a watcher thread which polls the segment until stop is called.
+        */
+
+    void stop();
+
+        /**
+         * Stops and joins the watcher thread if running.
+        */
+};
+
+
+#endif
@@ -0,0 +1,170 @@
+#ifndef BRANCH_DISPATCHER_HPP
+#define BRANCH_DISPATCHER_HPP
+
+#include "branch.hpp"
+#include "builds/branch_dispatch.hpp"
+
+
+#if !defined(X86_BUILD_BRANCH) || !defined(PLATFORM_LINUX_BRANCH)
+#error "Subscriber dispatch requires x86-64 Linux."
+#endif
+
+
+template <typename Func>
+class SubscriberDispatcher {
+
+    static_assert(!std::is_same_v<Func, Func>,
+                  "Subscribers must be of type void (*)(Args...) noexcept.");
+};
+
+
+template <typename... Args>
+class SubscriberDispatcher<void (*)(Args...) noexcept> :
+public dispatcher_aux<void (*)(Args...)> {
+
+    /**
+     * SubscriberDispatcher fans a call out to a list of subscribers which
+     * rarely changes. Rather than iterating over function pointers, each
+     * subscribe or unsubscribe assembles a stub containing a direct call to
+     * every subscriber, and patches the jump in the dispatch entry point to
+     * the new stub. Dispatching is then N direct calls, with no indirect
+     * branches and no loop.
+     * 
+     * Stubs are double buffered: the new stub is written to the inactive
+     * buffer before the entry jump is swapped with a single 4-byte release
+     * store, so a dispatch in flight on another thread completes on the old
+     * stub. The entry point is 16-byte aligned, so the jump offset at byte 1
+     * never straddles a cache line and the store is atomic. Two
+     * consecutive changes must not overlap a single in-flight dispatch.
+     * 
+     * The generated stubs carry no unwind information, so an exception could
+     * not propagate through them to the caller of dispatch. Subscribers must
+     * therefore be noexcept.
+    */
+
+    static_assert(sizeof...(Args) <= DISPATCH_MAX_ARGS_);
+    static_assert((dispatch_register_arg<Args> && ...),
+                  "Arguments must be integral, enum, pointer or reference types.");
+
+private:
+    using subscriber = void (*)(Args...) noexcept;
+
+    std::vector<subscriber> subscribers;
+    unsigned char* stubs;
+    unsigned char* active_stub;
+
+    void _rebuild(const std::vector<subscriber>& next) {
+
+        /**
+         * Args: the subscriber list to install.
+         * 
+         * Assembles the stub for next into the inactive buffer and swaps the
+         * entry jump over to it. The current list is left untouched if the
+         * stub cannot be assembled.
+        */
+
+        unsigned char* next_stub = active_stub == stubs ? stubs + DISPATCH_STUB_SIZE_ : stubs;
+        std::vector<void*> targets;
+        for (subscriber func : next)
+            targets.push_back(reinterpret_cast<void*>(func));
+        std::vector<unsigned char> code = assemble_dispatch_stub(next_stub, targets, sizeof...(Args));
+        unsigned char offset_in_bytes[OFFSET_];
+        store_offset_as_bytes(compute_jump_offset(next_stub, this->bytecode_to_edit - 1), offset_in_bytes);
+        uint32_t offset;
+        std::memcpy(&offset, offset_in_bytes, OFFSET_);
+        #ifdef SAFE_MODE
+        change_permissions(next_stub, permissions::READ_WRITE_EXECUTE);
+        #endif
+        std::memcpy(next_stub, code.data(), code.size());
+        #ifdef SAFE_MODE
+        change_permissions(next_stub, permissions::READ_EXECUTE);
+        change_permissions(this->bytecode_to_edit, permissions::READ_WRITE_EXECUTE);
+        #endif
+        __atomic_store_n(reinterpret_cast<uint32_t*>(this->bytecode_to_edit), offset, __ATOMIC_RELEASE);
+        #ifdef SAFE_MODE
+        change_permissions(this->bytecode_to_edit, permissions::READ_EXECUTE);
+        #endif
+        active_stub = next_stub;
+        subscribers = next;
+    }
+
+public:
+    SubscriberDispatcher() :
+    stubs(allocate_executable_near(this->bytecode_to_edit, 2 * DISPATCH_STUB_SIZE_)),
+    active_stub(nullptr) {
+        change_permissions(this->bytecode_to_edit, permissions::READ_WRITE_EXECUTE);
+        *this->bytecode_to_edit++ = JUMP_OPCODE_;
+        #ifdef SAFE_MODE
+        change_permissions(this->bytecode_to_edit, permissions::READ_EXECUTE);
+        #endif
+        _rebuild({});
+    }
+
+    SubscriberDispatcher(const SubscriberDispatcher&) = delete;
+    SubscriberDispatcher& operator=(const SubscriberDispatcher&) = delete;
+
+    ~SubscriberDispatcher() {
+
+        /**
+         * Turns the entry point into a ret before releasing the stubs, so a
+         * later call to dispatch is a no-op rather than a jump into unmapped
+         * memory.
+        */
+
+        #ifdef SAFE_MODE
+        change_permissions(this->bytecode_to_edit, permissions::READ_WRITE_EXECUTE);
+        #endif
+        *(this->bytecode_to_edit - 1) = RET_OPCODE_;
+        #ifdef SAFE_MODE
+        change_permissions(this->bytecode_to_edit, permissions::READ_EXECUTE);
+        #endif
+        release_executable(stubs, 2 * DISPATCH_STUB_SIZE_);
+    }
+
+    void subscribe(const subscriber func) {
+
+        /**
+         * Args: function to call on every dispatch, after existing subscribers.
+         * 
+         * Rebuilds the dispatch stub. Subscribers must lie within a 32-bit
+         * displacement of the stub, which holds for functions in the same
+         * binary as the dispatcher.
+         * 
+         * Cost: a stub rebuild and an SMC penalty on the next dispatch.
+        */
+
+        std::vector<subscriber> next = subscribers;
+        next.push_back(func);
+        _rebuild(next);
+    }
+
+    bool unsubscribe(const subscriber func) {
+
+        /**
+         * Args: previously subscribed function.
+         * 
+         * Ret: false if func was not subscribed.
+         * 
+         * Removes the first occurrence of func and rebuilds the dispatch stub.
+        */
+
+        std::vector<subscriber> next = subscribers;
+        auto it = std::find(next.begin(), next.end(), func);
+        if (it == next.end())
+            return false;
+        next.erase(it);
+        _rebuild(next);
+        return true;
+    }
+
+    size_t size() const {
+        return subscribers.size();
+    }
+};
+
+
+template <typename... Args>
+uint64_t dispatcher_aux<void (*)(Args...)>::instances = 0;
+
+
+#endif
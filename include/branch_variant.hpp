@@ -0,0 +1,162 @@
+#ifndef BRANCH_VARIANT_HPP
+#define BRANCH_VARIANT_HPP
+
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "branch.hpp"
+
+
+template <typename Visitor, typename Variant>
+class SemiStaticVisitor {
+
+    static_assert(!std::is_same_v<Variant, Variant>, "Variant must be a std::variant.");
+};
+
+
+template <typename Visitor, typename... Types>
+class SemiStaticVisitor<Visitor, std::variant<Types...>> {
+
+    /**
+     * SemiStaticVisitor owns a std::variant whose active alternative rarely
+     * changes, and visits it through a BranchChanger rather than the index
+     * load and jump table used by std::visit. Each alternative is given its
+     * own branch target which calls the matching visitor overload, and
+     * assigning a new alternative patches the entry point to jump directly
+     * to it. The targets access the alternative without checking the index,
+     * which is kept in step with the patched direction on every assignment.
+     * If an assignment throws and leaves the variant valueless, the entry
+     * point is patched to a target which throws std::bad_variant_access.
+     * As with BranchChanger, only one instance may exist per pair of visitor
+     * and variant types.
+    */
+
+    static_assert(sizeof...(Types) > 1);
+
+public:
+    using variant_type = std::variant<Types...>;
+    using return_type = std::invoke_result_t<Visitor&, std::variant_alternative_t<0, variant_type>&>;
+
+    static_assert((std::is_same_v<return_type, std::invoke_result_t<Visitor&, Types&>> && ...),
+                  "Visitor must return the same type for every alternative.");
+
+private:
+    template <std::size_t I>
+    static return_type _visit_alternative(Visitor& visitor, variant_type& value) {
+
+        /**
+         * Branch target for the I'th alternative. The entry point only jumps
+         * here while I is the active index, so the optimiser is told as much
+         * and drops the index check in std::get_if.
+        */
+
+        if (value.index() != I)
+            UNREACHABLE_BRANCH_();
+        return visitor(*std::get_if<I>(&value));
+    }
+
+    static return_type _visit_valueless(Visitor&, variant_type&) {
+
+        /**
+         * Branch target for a variant left valueless by a throwing assignment.
+        */
+
+        throw std::bad_variant_access();
+    }
+
+    template <std::size_t... Is>
+    static auto _make_changer(std::index_sequence<Is...>) {
+        return BranchChanger<decltype(&_visit_alternative<Is>)..., decltype(&_visit_valueless)>(
+            &_visit_alternative<Is>..., &_visit_valueless);
+    }
+
+    using changer_type = decltype(_make_changer(std::index_sequence_for<Types...>{}));
+
+    Visitor visitor;
+    variant_type value;
+    changer_type changer;
+
+    void _update_direction() {
+
+        /**
+         * Points the entry at the target for the active alternative, or at
+         * _visit_valueless (the last target) if the variant is valueless.
+        */
+
+        changer.set_direction(value.valueless_by_exception() ? sizeof...(Types) : value.index());
+        #ifdef DEFERRED_MODE
+        changer.sync();
+        #endif
+    }
+
+public:
+    template <typename T>
+    SemiStaticVisitor(Visitor visitor_, T&& alternative) :
+    visitor(std::move(visitor_)), value(std::forward<T>(alternative)),
+    changer(_make_changer(std::index_sequence_for<Types...>{})) {
+        _update_direction();
+    }
+
+    SemiStaticVisitor(const SemiStaticVisitor&) = delete;
+    SemiStaticVisitor& operator=(const SemiStaticVisitor&) = delete;
+
+    template <typename T, typename = std::enable_if_t<
+        !std::is_same_v<std::decay_t<T>, SemiStaticVisitor>>>
+    SemiStaticVisitor& operator=(T&& alternative) {
+
+        /**
+         * Args: a value convertible to one of the variant alternatives.
+         * 
+         * Assigns the variant and patches the visit entry point if the active
+         * alternative has changed.
+        */
+
+        try {
+            value = std::forward<T>(alternative);
+        } catch (...) {
+            _update_direction();
+            throw;
+        }
+        _update_direction();
+        return *this;
+    }
+
+    template <typename T, typename... Args>
+    T& emplace(Args&&... args) {
+
+        /**
+         * Args: arguments forwarded to the constructor of alternative T.
+         * 
+         * Same semantics as above method, but constructs the alternative
+         * in place.
+        */
+
+        T* alternative;
+        try {
+            alternative = &value.template emplace<T>(std::forward<Args>(args)...);
+        } catch (...) {
+            _update_direction();
+            throw;
+        }
+        _update_direction();
+        return *alternative;
+    }
+
+    return_type visit() {
+
+        /**
+         * Calls the visitor overload for the active alternative, through a
+         * direct call and a patched jump.
+        */
+
+        return changer.branch(visitor, value);
+    }
+
+    const variant_type& get() const {
+        return value;
+    }
+};
+
+
+#endif
@@ -13,6 +13,13 @@
 #endif
 
 
+#if defined(CLANG_BUILD_BRANCH) || defined(GCC_BUILD_BRANCH)
+#define UNREACHABLE_BRANCH_() __builtin_unreachable()
+#elif defined(MSVC_BUILD_BRANCH)
+#define UNREACHABLE_BRANCH_() __assume(0)
+#endif
+
+
 #if defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
 #define X86_BUILD_BRANCH
 #elif defined(__aarch64__) || defined(_M_ARM64)
@@ -40,19 +47,26 @@
 #endif
 
 
+#define NEAR_ALLOCATION_STEP_ (static_cast<intptr_t>(1) << 24)
+#define NEAR_ALLOCATION_RANGE_ (static_cast<intptr_t>(1) << 30)
+
+
 #ifdef X86_BUILD_BRANCH
 #define JUMP_INSTRUCTION asm ("jmp 0x0");
 #define INSTRUCTION_SIZE 5
 #define JUMP_OPCODE_ 0xE9
+#define CALL_OPCODE_ 0xE8
 #define RET_OPCODE_ 0xC3
 #define JUMP_DISTANCE_ 1ULL << 32
 #define OFFSET_ 4
+#define CACHE_LINE_SIZE_ 64
 #elif defined(ARM_BUILD_BRANCH)
 #define JUMP_INSTRUCTION asm ("b 0x0");
 #define JUMP_OPCODE_ 0xEA
 #define JUMP_DISTANCE_ 1ULL << 24
 #define INSTRUCTION_SIZE 4
 #define OFFSET_ 3
+#define CACHE_LINE_SIZE_ 64
 #endif
 
 
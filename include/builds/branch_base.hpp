@@ -9,5 +9,9 @@ template <typename T>
 class branch_changer_aux {};
 
 
+template <typename T>
+class dispatcher_aux {};
+
+
 #endif
 
@@ -53,4 +53,26 @@ public:
 };
 
 
+template <typename... Args>
+class dispatcher_aux<void (*)(Args...)> {
+
+protected:
+    unsigned char* bytecode_to_edit;
+    static uint64_t instances;
+
+public:
+    dispatcher_aux() : 
+    bytecode_to_edit((unsigned char*) &dispatcher_aux::dispatch) {
+        if (instances >= 1)
+            throw branch_changer_error(error_codes::MULTIPLE_INSTANCE_ERROR);
+        instances++;
+    }
+
+    __attribute__((hot,noinline,aligned(16)))
+    static void dispatch (Args... args) {
+        JUMP_INSTRUCTION
+    }
+};
+
+
 #endif
\ No newline at end of file
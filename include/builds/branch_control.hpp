@@ -0,0 +1,132 @@
+#ifndef BRANCH_CONTROL_HPP
+#define BRANCH_CONTROL_HPP
+
+
+#include "branch_utilities.hpp"
+
+
+#ifndef PLATFORM_LINUX_BRANCH
+#error "Control plane requires POSIX shared memory."
+#endif
+
+
+#define CONTROL_MAGIC_ 0x4252414E43484354ULL
+#define CONTROL_MAX_BRANCHES_ 64
+#define CONTROL_NAME_SIZE_ 32
+#define CONTROL_NO_DIRECTION_ UINT64_MAX
+
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+
+
+struct alignas(CACHE_LINE_SIZE_) control_entry {
+
+    /**
+     * A single registered branch within the shared memory segment. The name
+     * and number of directions are written once by the owning process before
+     * the entry is published. Requests are made by storing a direction and
+     * then bumping the sequence, which the watcher uses to detect new requests
+     * (including repeated requests for the same direction). Accepted is the
+     * last direction the watcher passed to set_direction. Under DEFERRED_MODE
+     * this only records the direction, which takes effect at the next sync.
+    */
+
+    char name[CONTROL_NAME_SIZE_];
+    uint64_t directions;
+    std::atomic<uint64_t> requested;
+    std::atomic<uint64_t> sequence;
+    std::atomic<uint64_t> accepted;
+};
+
+
+struct control_segment {
+
+    /**
+     * Layout of the shared memory segment. Entries [0, count) are published
+     * and may be read by other processes. Owner is the pid of the creating
+     * process, used to identify segments left behind by crashed processes.
+    */
+
+    uint64_t magic;
+    uint64_t owner;
+    std::atomic<uint64_t> count;
+    control_entry entries[CONTROL_MAX_BRANCHES_];
+};
+
+
+control_segment* create_control_segment(const std::string& name);
+
+    /**
+     * Args: name of the POSIX shared memory object, e.g "/my_process".
+     * 
+     * Ret: pointer to a freshly initialised segment mapped into memory.
+     * 
+     * Creates a new shared memory object and maps it. Fails if an object with
+     * the same name already exists, see remove_stale_control_segment.
+    */
+
+
+control_segment* open_control_segment(const std::string& name);
+
+    /**
+     * Args: name of an existing POSIX shared memory object.
+     * 
+     * Ret: pointer to the mapped segment.
+     * 
+     * Maps a segment created by another process, validating its size
+     * and magic number.
+    */
+
+
+void close_control_segment(control_segment* segment);
+
+    /**
+     * Args: segment previously returned by create/open_control_segment.
+     * 
+     * Unmaps the segment from the current process.
+    */
+
+
+void unlink_control_segment(const std::string& name);
+
+    /**
+     * Args: name of the POSIX shared memory object.
+     * 
+     * Removes the shared memory object, existing mappings remain valid.
+    */
+
+
+bool remove_stale_control_segment(const std::string& name);
+
+    /**
+     * Args: name of the POSIX shared memory object.
+     * 
+     * Ret: true if the segment was removed.
+     * 
+     * Removes a segment whose owning process no longer exists, e.g after a
+     * crash. Segments owned by a live process are left untouched.
+    */
+
+
+control_entry* find_control_entry(control_segment* segment, const std::string& branch_name);
+
+    /**
+     * Args: segment to search and the registered name of a branch.
+     * 
+     * Ret: pointer to the matching entry, or nullptr if not registered.
+    */
+
+
+void request_direction(control_segment* segment, const std::string& branch_name,
+                       const uint64_t direction);
+
+    /**
+     * Args: segment to write to, registered name of a branch and the desired
+     *       branch direction.
+     * 
+     * Publishes a request for a new branch direction, which is accepted by the
+     * watcher in the owning process.
+    */
+
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef BRANCH_DISPATCH_HPP
+#define BRANCH_DISPATCH_HPP
+
+
+#include <type_traits>
+#include "branch_utilities.hpp"
+
+
+#define DISPATCH_MAX_ARGS_ 5
+#define DISPATCH_STUB_SIZE_ 4096
+
+
+template <typename T>
+constexpr bool dispatch_register_arg = std::is_reference_v<T> ||
+    ((std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>) && sizeof(T) <= 8);
+
+    /**
+     * True if T is passed in a single general purpose register, which is
+     * what the generated stubs save and restore between subscriber calls.
+    */
+
+
+std::vector<unsigned char> assemble_dispatch_stub(const unsigned char* location,
+                                                  const std::vector<void*>& targets,
+                                                  const size_t arg_count);
+
+    /**
+     * Args: location is the address the stub will be copied to
+     *       targets are the subscribers in the order they are called
+     *       arg_count is the number of register arguments to preserve
+     * 
+     * Ret: machine code for the stub.
+     * 
+     * Assembles a straight-line sequence of direct calls to each target. The
+     * argument registers are saved in callee saved registers and reloaded
+     * before every call, and the final target is reached with a tail jump.
+     * Targets must be within a 32-bit displacement of location, and the stub
+     * must fit in DISPATCH_STUB_SIZE_ bytes.
+    */
+
+
+#endif
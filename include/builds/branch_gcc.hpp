@@ -61,4 +61,30 @@ public:
 };
 
 
+template <typename... Args>
+class dispatcher_aux<void (*)(Args...)> {
+
+protected:
+    unsigned char* bytecode_to_edit;
+    static uint64_t instances;
+
+public:
+    dispatcher_aux() : 
+    bytecode_to_edit((unsigned char*) &dispatcher_aux::dispatch) {
+        if (instances >= 1)
+            throw branch_changer_error(error_codes::MULTIPLE_INSTANCE_ERROR);
+        instances++;
+    }
+
+    #if defined(PLATFORM_LINUX_BRANCH) && !defined(ARM_BUILD_BRANCH)
+    __attribute__((hot,noipa,aligned(16),nocf_check,optimize("no-ipa-cp-clone,O3")))
+    #else
+    __attribute__((hot,noipa,aligned(16),optimize("no-ipa-cp-clone,O3")))
+    #endif
+    static void dispatch (Args... args) {
+        JUMP_INSTRUCTION
+    }
+};
+
+
 #endif
\ No newline at end of file
@@ -8,7 +8,11 @@
 enum class error_codes {
     BRANCH_TARGET_OUT_OF_BOUNDS,
     MULTIPLE_INSTANCE_ERROR,
-    PAGE_PERMISSIONS_ERROR
+    PAGE_PERMISSIONS_ERROR,
+    CONTROL_SEGMENT_ERROR,
+    CONTROL_REGISTRY_ERROR,
+    CONTROL_REQUEST_ERROR,
+    DISPATCH_STUB_ERROR
 };
 
 
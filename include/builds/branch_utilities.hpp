@@ -6,6 +6,7 @@
 #include <cstring>
 #include <vector>
 #include <algorithm>
+#include <atomic>
 
 #include "branch_arch.hpp"
 #include "branch_misc.hpp"
@@ -23,9 +24,9 @@ intptr_t compute_jump_offset(Func_A src, Func_B dst) {
      * functions in memory.
     */
 
-    void* src_addr = reinterpret_cast<void*>(src);
-    void* dst_addr = reinterpret_cast<void*>(dst);
-    return (char*)src_addr - (char*)dst_addr - INSTRUCTION_SIZE;
+    const void* src_addr = reinterpret_cast<const void*>(src);
+    const void* dst_addr = reinterpret_cast<const void*>(dst);
+    return (const char*)src_addr - (const char*)dst_addr - INSTRUCTION_SIZE;
 }
 
 
@@ -46,6 +47,33 @@ void change_permissions(const unsigned char* address, const permissions& config)
     */
 
 
+#ifdef PLATFORM_LINUX_BRANCH
+
+unsigned char* allocate_executable_near(const unsigned char* address, const size_t size);
+
+    /**
+     * Args: address is a function pointer cast to unsigned chars
+     *       size is the number of bytes to allocate, a multiple of the page size
+     * 
+     * Ret: page aligned RWX region within a 1GiB displacement of address.
+     * 
+     * Allocates executable memory close enough to the text segment for code
+     * in the region to reach functions near address with 32-bit relative
+     * calls and jumps.
+    */
+
+
+void release_executable(unsigned char* region, const size_t size);
+
+    /**
+     * Args: region previously returned by allocate_executable_near and its size.
+     * 
+     * Releases the executable region.
+    */
+
+#endif
+
+
 void store_offset_as_bytes(const intptr_t& offset, unsigned char* dst);
 
     /**
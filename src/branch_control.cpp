@@ -0,0 +1,167 @@
+
+#include <cerrno>
+#include <new>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "branch_control.hpp"
+
+
+control_segment* create_control_segment(const std::string& name) {
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd == -1)
+        throw branch_changer_error(error_codes::CONTROL_SEGMENT_ERROR);
+    if (ftruncate(fd, sizeof(control_segment)) == -1) {
+        close(fd);
+        shm_unlink(name.c_str());
+        throw branch_changer_error(error_codes::CONTROL_SEGMENT_ERROR);
+    }
+    void* addr = mmap(nullptr, sizeof(control_segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        throw branch_changer_error(error_codes::CONTROL_SEGMENT_ERROR);
+    }
+    auto segment = new (addr) control_segment();
+    segment->owner = static_cast<uint64_t>(getpid());
+    segment->magic = CONTROL_MAGIC_;
+    return segment;
+}
+
+
+control_segment* open_control_segment(const std::string& name) {
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd == -1)
+        throw branch_changer_error(error_codes::CONTROL_SEGMENT_ERROR);
+    struct stat info;
+    if (fstat(fd, &info) == -1 || info.st_size != (off_t)sizeof(control_segment)) {
+        close(fd);
+        throw branch_changer_error(error_codes::CONTROL_SEGMENT_ERROR);
+    }
+    void* addr = mmap(nullptr, sizeof(control_segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED)
+        throw branch_changer_error(error_codes::CONTROL_SEGMENT_ERROR);
+    auto segment = static_cast<control_segment*>(addr);
+    if (segment->magic != CONTROL_MAGIC_) {
+        munmap(addr, sizeof(control_segment));
+        throw branch_changer_error(error_codes::CONTROL_SEGMENT_ERROR);
+    }
+    return segment;
+}
+
+
+void close_control_segment(control_segment* segment) {
+    munmap(segment, sizeof(control_segment));
+}
+
+
+void unlink_control_segment(const std::string& name) {
+    shm_unlink(name.c_str());
+}
+
+
+bool remove_stale_control_segment(const std::string& name) {
+    control_segment* segment;
+    try {
+        segment = open_control_segment(name);
+    } catch (const branch_changer_error&) {
+        return false;
+    }
+    auto owner = static_cast<pid_t>(segment->owner);
+    close_control_segment(segment);
+    if (kill(owner, 0) == 0 || errno != ESRCH)
+        return false;
+    unlink_control_segment(name);
+    return true;
+}
+
+
+control_entry* find_control_entry(control_segment* segment, const std::string& branch_name) {
+    uint64_t count = segment->count.load(std::memory_order_acquire);
+    for (uint64_t i = 0; i < count && i < CONTROL_MAX_BRANCHES_; i++) {
+        control_entry* entry = &segment->entries[i];
+        if (std::strncmp(entry->name, branch_name.c_str(), CONTROL_NAME_SIZE_) == 0)
+            return entry;
+    }
+    return nullptr;
+}
+
+
+void request_direction(control_segment* segment, const std::string& branch_name,
+                       const uint64_t direction) {
+    control_entry* entry = find_control_entry(segment, branch_name);
+    if (entry == nullptr || direction >= entry->directions)
+        throw branch_changer_error(error_codes::CONTROL_REQUEST_ERROR);
+    entry->requested.store(direction, std::memory_order_relaxed);
+    entry->sequence.fetch_add(1, std::memory_order_release);
+}
+
+
+BranchControlPlane::BranchControlPlane(const std::string& name) :
+segment_name(name), segment(create_control_segment(name)), running(false) {}
+
+
+BranchControlPlane::~BranchControlPlane() {
+    stop();
+    close_control_segment(segment);
+    unlink_control_segment(segment_name);
+}
+
+
+void BranchControlPlane::_register(const std::string& name, const uint64_t directions,
+                                   void* branch, applier apply) {
+    std::lock_guard<std::mutex> guard(handles_lock);
+    uint64_t index = segment->count.load(std::memory_order_relaxed);
+    if (name.empty() || name.size() >= CONTROL_NAME_SIZE_ || index >= CONTROL_MAX_BRANCHES_
+        || find_control_entry(segment, name) != nullptr)
+        throw branch_changer_error(error_codes::CONTROL_REGISTRY_ERROR);
+    control_entry* entry = &segment->entries[index];
+    std::memcpy(entry->name, name.c_str(), name.size() + 1);
+    entry->directions = directions;
+    entry->accepted.store(CONTROL_NO_DIRECTION_, std::memory_order_relaxed);
+    handles.push_back({ entry, entry->sequence.load(std::memory_order_relaxed), directions, branch, apply });
+    segment->count.store(index + 1, std::memory_order_release);
+}
+
+
+void BranchControlPlane::poll() {
+    std::lock_guard<std::mutex> guard(handles_lock);
+    for (handle& h : handles) {
+        uint64_t sequence = h.entry->sequence.load(std::memory_order_acquire);
+        if (sequence == h.last_sequence)
+            continue;
+        h.last_sequence = sequence;
+        uint64_t direction = h.entry->requested.load(std::memory_order_relaxed);
+        if (direction >= h.directions)
+            continue;
+        h.apply(h.branch, direction);
+        h.entry->accepted.store(direction, std::memory_order_release);
+    }
+}
+
+
+void BranchControlPlane::_watch(const std::chrono::microseconds interval) {
+    while (running.load(std::memory_order_acquire)) {
+        poll();
+        std::this_thread::sleep_for(interval);
+    }
+}
+
+
+void BranchControlPlane::start(const std::chrono::microseconds interval) {
+    if (running.exchange(true))
+        return;
+    watcher = std::thread(&BranchControlPlane::_watch, this, interval);
+}
+
+
+void BranchControlPlane::stop() {
+    if (!running.exchange(false))
+        return;
+    if (watcher.joinable())
+        watcher.join();
+}
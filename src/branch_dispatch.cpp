@@ -0,0 +1,78 @@
+
+#include "builds/branch_dispatch.hpp"
+
+
+#if defined(X86_BUILD_BRANCH) && defined(PLATFORM_LINUX_BRANCH)
+
+// System V argument registers rdi, rsi, rdx, rcx, r8 are paired with the
+// callee saved registers rbx, r12, r13, r14, r15 respectively.
+
+static const unsigned char push_saved[] = {
+    0x53, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56, 0x41, 0x57
+};
+
+static const unsigned char pop_saved[] = {
+    0x41, 0x5F, 0x41, 0x5E, 0x41, 0x5D, 0x41, 0x5C, 0x5B
+};
+
+static const unsigned char save_arg[DISPATCH_MAX_ARGS_][3] = {
+    { 0x48, 0x89, 0xFB }, { 0x49, 0x89, 0xF4 }, { 0x49, 0x89, 0xD5 },
+    { 0x49, 0x89, 0xCE }, { 0x4D, 0x89, 0xC7 }
+};
+
+static const unsigned char load_arg[DISPATCH_MAX_ARGS_][3] = {
+    { 0x48, 0x89, 0xDF }, { 0x4C, 0x89, 0xE6 }, { 0x4C, 0x89, 0xEA },
+    { 0x4C, 0x89, 0xF1 }, { 0x4D, 0x89, 0xF8 }
+};
+
+
+static void emit_bytes(std::vector<unsigned char>& code, const unsigned char* bytes, const size_t size) {
+    code.insert(code.end(), bytes, bytes + size);
+}
+
+
+static void emit_relative(std::vector<unsigned char>& code, const unsigned char* location,
+                          const unsigned char opcode, void* target) {
+    intptr_t offset = compute_jump_offset(target, location + code.size());
+    if (offset > INT32_MAX || offset < INT32_MIN)
+        throw branch_changer_error(error_codes::BRANCH_TARGET_OUT_OF_BOUNDS);
+    unsigned char offset_in_bytes[OFFSET_];
+    store_offset_as_bytes(offset, offset_in_bytes);
+    code.push_back(opcode);
+    emit_bytes(code, offset_in_bytes, OFFSET_);
+}
+
+
+std::vector<unsigned char> assemble_dispatch_stub(const unsigned char* location,
+                                                  const std::vector<void*>& targets,
+                                                  const size_t arg_count) {
+    if (arg_count > DISPATCH_MAX_ARGS_)
+        throw branch_changer_error(error_codes::DISPATCH_STUB_ERROR);
+    std::vector<unsigned char> code;
+    if (targets.empty()) {
+        code.push_back(RET_OPCODE_);
+        return code;
+    }
+    if (targets.size() > 1) {
+        // Pushing five registers on top of the return address leaves the
+        // stack 16-byte aligned for the calls below.
+        emit_bytes(code, push_saved, sizeof(push_saved));
+        for (size_t i = 0; i < arg_count; i++)
+            emit_bytes(code, save_arg[i], 3);
+        for (size_t t = 0; t + 1 < targets.size(); t++) {
+            if (t > 0)
+                for (size_t i = 0; i < arg_count; i++)
+                    emit_bytes(code, load_arg[i], 3);
+            emit_relative(code, location, CALL_OPCODE_, targets[t]);
+        }
+        for (size_t i = 0; i < arg_count; i++)
+            emit_bytes(code, load_arg[i], 3);
+        emit_bytes(code, pop_saved, sizeof(pop_saved));
+    }
+    emit_relative(code, location, JUMP_OPCODE_, targets.back());
+    if (code.size() > DISPATCH_STUB_SIZE_)
+        throw branch_changer_error(error_codes::DISPATCH_STUB_ERROR);
+    return code;
+}
+
+#endif
@@ -23,6 +23,26 @@ std::string err_to_str(const error_codes& code) {
 
             return R"("Unable to change page permissions for the given function pointers.)";
 
+        case error_codes::CONTROL_SEGMENT_ERROR:
+
+            return R"(Unable to create, open or map the shared memory segment for the control plane.
+		      The segment may not exist, or may not have been created by a control plane.)";
+
+        case error_codes::CONTROL_REGISTRY_ERROR:
+
+            return R"(Unable to register branch with the control plane. Names must be unique and
+		      shorter than the maximum name length, and the segment must have a free slot.)";
+
+        case error_codes::CONTROL_REQUEST_ERROR:
+
+            return R"(Requested branch is not registered with the control plane, or the requested
+		      direction exceeds the number of branches it was constructed with.)";
+
+        case error_codes::DISPATCH_STUB_ERROR:
+
+            return R"(Unable to allocate executable memory within a 32-bit displacement of the dispatch
+		      entry point, or the subscriber list exceeds the capacity of the dispatch stub.)";
+
         default:
 
             return "Runtime error.";
@@ -42,6 +42,30 @@ void change_permissions(const unsigned char* address, const permissions& config)
     }
 }
 
+unsigned char* allocate_executable_near(const unsigned char* address, const size_t size) {
+    intptr_t page_size = getpagesize();
+    auto origin = reinterpret_cast<intptr_t>(address);
+    origin -= origin % page_size;
+    for (intptr_t distance = NEAR_ALLOCATION_STEP_; distance < NEAR_ALLOCATION_RANGE_;
+         distance += NEAR_ALLOCATION_STEP_) {
+        for (intptr_t hint : { origin - distance, origin + distance }) {
+            void* region = mmap(reinterpret_cast<void*>(hint), size, PROT_READ | PROT_WRITE | PROT_EXEC,
+                                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (region == MAP_FAILED)
+                continue;
+            intptr_t displacement = reinterpret_cast<intptr_t>(region) - origin;
+            if (displacement > -NEAR_ALLOCATION_RANGE_ && displacement < NEAR_ALLOCATION_RANGE_)
+                return static_cast<unsigned char*>(region);
+            munmap(region, size);
+        }
+    }
+    throw branch_changer_error(error_codes::DISPATCH_STUB_ERROR);
+}
+
+void release_executable(unsigned char* region, const size_t size) {
+    munmap(region, size);
+}
+
 #endif
 
 
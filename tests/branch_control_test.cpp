@@ -0,0 +1,219 @@
+#include <gtest/gtest.h>
+#include <branch_control.hpp>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+extern char** environ;
+
+
+int add(int a, int b) { return a + b; }
+int sub(int a, int b) { return a - b; }
+int mul(int a, int b) { return a * b; }
+
+
+static std::string segment_name() {
+    return "/branch_control_test_" + std::to_string(getpid());
+}
+
+
+static bool wait_for(BranchChanger<int(*)(int,int), int(*)(int,int), int(*)(int,int)>& branch, int expected) {
+    for (int i = 0; i < 100000; i++) {
+        if (branch.branch(1,2) == expected)
+            return true;
+        std::this_thread::sleep_for(std::chrono::microseconds(10));
+    }
+    return false;
+}
+
+
+struct ctl_result {
+    pid_t pid;
+    int status;
+    std::string output;
+};
+
+
+static ctl_result run_branch_ctl(std::vector<std::string> args) {
+
+    // Runs the branch_ctl tool built alongside the library, capturing stdout.
+
+    args.insert(args.begin(), BRANCH_CTL_PATH);
+    std::vector<char*> argv;
+    for (std::string& arg : args)
+        argv.push_back(arg.data());
+    argv.push_back(nullptr);
+    int fds[2];
+    if (pipe(fds) == -1)
+        return { -1, -1, "" };
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addclose(&actions, fds[0]);
+    posix_spawn_file_actions_addclose(&actions, fds[1]);
+    ctl_result result = { -1, -1, "" };
+    int err = posix_spawn(&result.pid, argv[0], &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(fds[1]);
+    if (err == 0) {
+        char buffer[256];
+        ssize_t n;
+        while ((n = read(fds[0], buffer, sizeof(buffer))) > 0)
+            result.output.append(buffer, n);
+        waitpid(result.pid, &result.status, 0);
+    }
+    close(fds[0]);
+    return result;
+}
+
+
+static int exit_code(const ctl_result& result) {
+    return WIFEXITED(result.status) ? WEXITSTATUS(result.status) : -1;
+}
+
+
+TEST(ControlSegment1, OpenMissing) {
+    try {
+        open_control_segment(segment_name());
+        FAIL() << "Expecting control segment exception.";
+    } catch (branch_changer_error e) {
+        EXPECT_EQ(e.what(), err_to_str(error_codes::CONTROL_SEGMENT_ERROR));
+    }
+}
+
+
+TEST(ControlSegment2, RequestUnknown) {
+    BranchControlPlane plane(segment_name());
+    control_segment* segment = open_control_segment(segment_name());
+    try {
+        request_direction(segment, "missing", 0);
+        FAIL() << "Expecting control request exception.";
+    } catch (branch_changer_error e) {
+        EXPECT_EQ(e.what(), err_to_str(error_codes::CONTROL_REQUEST_ERROR));
+    }
+    close_control_segment(segment);
+}
+
+
+TEST(ControlSegment3, ExistingSegment) {
+    BranchControlPlane plane(segment_name());
+    try {
+        BranchControlPlane other(segment_name());
+        FAIL() << "Expecting control segment exception.";
+    } catch (branch_changer_error e) {
+        EXPECT_EQ(e.what(), err_to_str(error_codes::CONTROL_SEGMENT_ERROR));
+    }
+    EXPECT_FALSE(remove_stale_control_segment(segment_name()));
+    control_segment* segment = open_control_segment(segment_name());
+    close_control_segment(segment);
+}
+
+
+TEST(ControlSegment4, StaleSegment) {
+    // The pid of an exited and reaped branch_ctl stands in for a crashed owner.
+    ctl_result exited = run_branch_ctl({});
+    ASSERT_EQ(exit_code(exited), 2);
+    control_segment* segment = create_control_segment(segment_name());
+    segment->owner = static_cast<uint64_t>(exited.pid);
+    close_control_segment(segment);
+    EXPECT_TRUE(remove_stale_control_segment(segment_name()));
+    BranchControlPlane plane(segment_name());
+}
+
+
+TEST(BranchControlPlane1, Registry) {
+    BranchChanger branch(add, sub, mul);
+    BranchControlPlane plane(segment_name());
+    plane.register_branch("arith", branch);
+    try {
+        plane.register_branch("arith", branch);
+        FAIL() << "Expecting control registry exception.";
+    } catch (branch_changer_error e) {
+        EXPECT_EQ(e.what(), err_to_str(error_codes::CONTROL_REGISTRY_ERROR));
+    }
+    control_segment* segment = open_control_segment(segment_name());
+    try {
+        request_direction(segment, "arith", 3);
+        FAIL() << "Expecting control request exception.";
+    } catch (branch_changer_error e) {
+        EXPECT_EQ(e.what(), err_to_str(error_codes::CONTROL_REQUEST_ERROR));
+    }
+    request_direction(segment, "arith", 2);
+    plane.poll();
+    EXPECT_EQ(branch.branch(1,2), 2);
+    EXPECT_EQ(find_control_entry(segment, "arith")->accepted.load(), 2u);
+    close_control_segment(segment);
+}
+
+
+TEST(BranchControlPlane2, UntrustedDirections) {
+    BranchChanger branch(add, sub, mul);
+    BranchControlPlane plane(segment_name());
+    plane.register_branch("arith", branch);
+    control_segment* segment = open_control_segment(segment_name());
+    control_entry* entry = find_control_entry(segment, "arith");
+    entry->directions = 1000000;
+    request_direction(segment, "arith", 999999);
+    plane.poll();
+    EXPECT_EQ(branch.branch(1,2), 3);
+    EXPECT_EQ(entry->accepted.load(), CONTROL_NO_DIRECTION_);
+    close_control_segment(segment);
+}
+
+
+TEST(BranchControlPlane3, CrossProcess) {
+    BranchChanger branch(add, sub, mul);
+    std::string name = segment_name();
+    BranchControlPlane plane(name);
+    plane.register_branch("arith", branch);
+    plane.start();
+    EXPECT_EQ(branch.branch(1,2), 3);
+    for (uint64_t direction : { 2, 1, 0 }) {
+        ctl_result result = run_branch_ctl({ name, "set", "arith", std::to_string(direction) });
+        ASSERT_EQ(exit_code(result), 0);
+        EXPECT_TRUE(wait_for(branch, direction == 0 ? 3 : direction == 1 ? -1 : 2));
+    }
+    plane.stop();
+}
+
+
+TEST(BranchCtl1, List) {
+    BranchChanger branch(add, sub, mul);
+    BranchControlPlane plane(segment_name());
+    plane.register_branch("arith", branch);
+    ctl_result result = run_branch_ctl({ segment_name(), "list" });
+    EXPECT_EQ(exit_code(result), 0);
+    EXPECT_EQ(result.output, "arith\tdirections=3\taccepted=-\n");
+    ASSERT_EQ(exit_code(run_branch_ctl({ segment_name(), "set", "arith", "1" })), 0);
+    plane.poll();
+    result = run_branch_ctl({ segment_name(), "list" });
+    EXPECT_EQ(result.output, "arith\tdirections=3\taccepted=1\n");
+}
+
+
+TEST(BranchCtl2, InvalidRequests) {
+    BranchChanger branch(add, sub, mul);
+    BranchControlPlane plane(segment_name());
+    plane.register_branch("arith", branch);
+    EXPECT_EQ(exit_code(run_branch_ctl({ segment_name(), "set", "arith", "3" })), 1);
+    EXPECT_EQ(exit_code(run_branch_ctl({ segment_name(), "set", "missing", "0" })), 1);
+    EXPECT_EQ(exit_code(run_branch_ctl({ segment_name(), "set", "arith", "x" })), 2);
+    EXPECT_EQ(exit_code(run_branch_ctl({ segment_name(), "unknown" })), 2);
+    EXPECT_EQ(exit_code(run_branch_ctl({ "/branch_control_missing", "list" })), 1);
+}
+
+
+TEST(BranchCtl3, Cleanup) {
+    {
+        BranchControlPlane plane(segment_name());
+        EXPECT_EQ(exit_code(run_branch_ctl({ segment_name(), "cleanup" })), 1);
+        close_control_segment(open_control_segment(segment_name()));
+    }
+    ctl_result exited = run_branch_ctl({});
+    control_segment* segment = create_control_segment(segment_name());
+    segment->owner = static_cast<uint64_t>(exited.pid);
+    close_control_segment(segment);
+    EXPECT_EQ(exit_code(run_branch_ctl({ segment_name(), "cleanup" })), 0);
+    EXPECT_THROW(open_control_segment(segment_name()), branch_changer_error);
+}
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include <branch.hpp>
+
+
+int add(int a, int b) { return a + b; }
+int sub(int a, int b) { return a - b; }
+int mul(int a, int b) { return a * b; }
+
+
+// For GitHub workflows bug on Windows.
+// Tests work locally.
+#ifndef GITHUB_WORKFLOW_WINDOWS
+
+TEST(DeferredBranchChanger1, PendingUntilSync) {
+    BranchChanger branch(add, sub);
+    branch.set_direction(true);
+    branch.sync();
+    branch.set_direction(false);
+    EXPECT_EQ(branch.branch(1,2), 3);
+    branch.sync();
+    EXPECT_EQ(branch.branch(1,2), -1);
+}
+
+
+TEST(DeferredBranchChanger2, CoalescedFlips) {
+    BranchChanger branch(add, sub, mul);
+    branch.set_direction(0);
+    branch.sync();
+    for (int i = 0; i < 100; i++)
+        branch.set_direction(i % 3);
+    branch.set_direction(2);
+    EXPECT_EQ(branch.branch(1,2), 3);
+    branch.sync();
+    EXPECT_EQ(branch.branch(1,2), 2);
+}
+
+
+TEST(DeferredBranchChanger3, Functionality) {
+    BranchChanger branch(add, sub);
+    bool condition = std::rand() % 2;
+    for (int i = 0; i < 100; i++) {
+        branch.set_direction(condition);
+        EXPECT_EQ(branch.synced_branch(1,2), condition ? 3 : -1);
+        condition = std::rand() % 2;
+    } 
+}
+
+#endif
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <branch_dispatch.hpp>
+
+
+struct Quote { int bid; int ask; };
+
+static std::vector<int> calls;
+static int spread_total = 0;
+
+void on_quote_1(const Quote& q) noexcept { calls.push_back(1); spread_total += q.ask - q.bid; }
+void on_quote_2(const Quote& q) noexcept { calls.push_back(2); spread_total += q.ask - q.bid; }
+void on_quote_3(const Quote& q) noexcept { calls.push_back(3); spread_total += q.ask - q.bid; }
+
+static int64_t checksum = 0;
+
+void on_fill(int64_t a, int64_t b, int64_t c, int64_t d, int64_t e) noexcept {
+    checksum += a + 2 * b + 3 * c + 4 * d + 5 * e;
+}
+
+
+TEST(DispatchStub1, Empty) {
+    unsigned char location[1];
+    std::vector<unsigned char> code = assemble_dispatch_stub(location, {}, 0);
+    ASSERT_EQ(code.size(), 1u);
+    EXPECT_EQ(code[0], RET_OPCODE_);
+}
+
+
+TEST(DispatchStub2, SingleTailJump) {
+    unsigned char* location = reinterpret_cast<unsigned char*>(0xff);
+    void* target = location + 12;
+    std::vector<unsigned char> code = assemble_dispatch_stub(location, { target }, 1);
+    ASSERT_EQ(code.size(), 5u);
+    EXPECT_EQ(code[0], JUMP_OPCODE_);
+    EXPECT_EQ(code[1], 0x07);
+}
+
+
+TEST(DispatchStub3, OutOfBounds) {
+    unsigned char* location = reinterpret_cast<unsigned char*>(0xff);
+    void* target = location + (static_cast<intptr_t>(1) << 34);
+    try {
+        assemble_dispatch_stub(location, { target }, 0);
+        FAIL() << "Expecting out of bounds exception.";
+    } catch (branch_changer_error e) {
+        EXPECT_EQ(e.what(), err_to_str(error_codes::BRANCH_TARGET_OUT_OF_BOUNDS));
+    }
+}
+
+
+TEST(SubscriberDispatcher1, Functionality) {
+    SubscriberDispatcher<void (*)(const Quote&) noexcept> bus;
+    Quote quote{ 100, 103 };
+    bus.dispatch(quote);
+    EXPECT_TRUE(calls.empty());
+    bus.subscribe(on_quote_1);
+    bus.dispatch(quote);
+    bus.subscribe(on_quote_2);
+    bus.subscribe(on_quote_3);
+    bus.dispatch(quote);
+    EXPECT_EQ(calls, std::vector<int>({ 1, 1, 2, 3 }));
+    EXPECT_EQ(spread_total, 12);
+    EXPECT_TRUE(bus.unsubscribe(on_quote_2));
+    EXPECT_FALSE(bus.unsubscribe(on_quote_2));
+    calls.clear();
+    bus.dispatch(quote);
+    EXPECT_EQ(calls, std::vector<int>({ 1, 3 }));
+    EXPECT_EQ(bus.size(), 2u);
+}
+
+
+TEST(SubscriberDispatcher2, PreservesArguments) {
+    SubscriberDispatcher<void (*)(int64_t, int64_t, int64_t, int64_t, int64_t) noexcept> bus;
+    for (int i = 0; i < 100; i++)
+        bus.subscribe(on_fill);
+    bus.dispatch(1, 2, 3, 4, 5);
+    EXPECT_EQ(checksum, 100 * (1 + 4 + 9 + 16 + 25));
+}
+
+
+TEST(SubscriberDispatcher3, DispatchAfterDestruction) {
+    using dispatcher = SubscriberDispatcher<void (*)(const Quote&) noexcept>;
+    {
+        dispatcher bus;
+        bus.subscribe(on_quote_1);
+    }
+    calls.clear();
+    dispatcher::dispatch(Quote{ 1, 2 });
+    EXPECT_TRUE(calls.empty());
+}
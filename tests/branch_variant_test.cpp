@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include <branch_variant.hpp>
+#include <stdexcept>
+#include <string>
+
+
+struct Venue { int id; };
+struct Halted {};
+
+
+struct Describe {
+    std::string operator()(int v) { return "int " + std::to_string(v); }
+    std::string operator()(const std::string& v) { return "string " + v; }
+    std::string operator()(Venue& v) { return "venue " + std::to_string(v.id); }
+};
+
+
+struct Route {
+    int operator()(Venue& v) { return v.id; }
+    int operator()(Halted&) { return -1; }
+};
+
+
+struct Throws {
+    Throws() = default;
+    Throws(const Throws&) { throw std::runtime_error("copy"); }
+};
+
+
+struct Kind {
+    int operator()(int) { return 0; }
+    int operator()(Throws&) { return 1; }
+};
+
+
+template <int N>
+struct Alternative { int value; };
+
+
+struct Sum {
+    template <int N>
+    int operator()(Alternative<N>& a) { return N + a.value; }
+};
+
+
+template <int... Ns>
+using alternatives = std::variant<Alternative<Ns>...>;
+
+
+// For GitHub workflows bug on Windows.
+// Tests work locally.
+#ifndef GITHUB_WORKFLOW_WINDOWS
+
+TEST(SemiStaticVisitor1, Functionality) {
+    SemiStaticVisitor<Describe, std::variant<int, std::string, Venue>> visitor(Describe{}, 7);
+    EXPECT_EQ(visitor.visit(), "int 7");
+    visitor = std::string("config");
+    EXPECT_EQ(visitor.visit(), "string config");
+    visitor.emplace<Venue>(Venue{42});
+    EXPECT_EQ(visitor.visit(), "venue 42");
+    visitor = 3;
+    EXPECT_EQ(visitor.visit(), "int 3");
+    EXPECT_EQ(visitor.get().index(), 0u);
+}
+
+
+TEST(SemiStaticVisitor2, TwoAlternatives) {
+    SemiStaticVisitor<Route, std::variant<Venue, Halted>> visitor(Route{}, Venue{5});
+    for (int i = 0; i < 100; i++) {
+        bool halted = std::rand() % 2;
+        if (halted)
+            visitor = Halted{};
+        else
+            visitor = Venue{i};
+        EXPECT_EQ(visitor.visit(), halted ? -1 : i);
+    }
+}
+
+
+TEST(SemiStaticVisitor3, ManyAlternatives) {
+    using variant = alternatives<
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+        16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31
+    >;
+    SemiStaticVisitor<Sum, variant> visitor(Sum{}, Alternative<0>{100});
+    EXPECT_EQ(visitor.visit(), 100);
+    visitor = Alternative<17>{100};
+    EXPECT_EQ(visitor.visit(), 117);
+    visitor = Alternative<31>{1};
+    EXPECT_EQ(visitor.visit(), 32);
+    visitor.emplace<Alternative<5>>(Alternative<5>{0});
+    EXPECT_EQ(visitor.visit(), 5);
+}
+
+
+TEST(SemiStaticVisitor4, Valueless) {
+    SemiStaticVisitor<Kind, std::variant<int, Throws>> visitor(Kind{}, 1);
+    EXPECT_EQ(visitor.visit(), 0);
+    Throws source;
+    EXPECT_THROW(visitor.emplace<Throws>(source), std::runtime_error);
+    ASSERT_TRUE(visitor.get().valueless_by_exception());
+    EXPECT_THROW(visitor.visit(), std::bad_variant_access);
+    visitor = 2;
+    EXPECT_EQ(visitor.visit(), 0);
+}
+
+#endif
@@ -0,0 +1,58 @@
+
+#include <iostream>
+#include "builds/branch_control.hpp"
+
+
+static int usage() {
+    std::cerr << "usage: branch_ctl <segment> list\n"
+              << "       branch_ctl <segment> set <branch> <direction>\n"
+              << "       branch_ctl <segment> cleanup\n";
+    return 2;
+}
+
+
+static void list_branches(control_segment* segment) {
+    uint64_t count = segment->count.load(std::memory_order_acquire);
+    for (uint64_t i = 0; i < count && i < CONTROL_MAX_BRANCHES_; i++) {
+        const control_entry& entry = segment->entries[i];
+        uint64_t accepted = entry.accepted.load(std::memory_order_acquire);
+        std::cout << entry.name << "\tdirections=" << entry.directions << "\taccepted=";
+        if (accepted == CONTROL_NO_DIRECTION_)
+            std::cout << "-";
+        else
+            std::cout << accepted;
+        std::cout << "\n";
+    }
+}
+
+
+int main(int argc, char** argv) {
+    if (argc < 3)
+        return usage();
+    std::string command = argv[2];
+    if (command == "cleanup" && argc == 3) {
+        if (!remove_stale_control_segment(argv[1])) {
+            std::cerr << "Segment is missing or owned by a live process.\n";
+            return 1;
+        }
+        return 0;
+    }
+    try {
+        control_segment* segment = open_control_segment(argv[1]);
+        if (command == "list" && argc == 3)
+            list_branches(segment);
+        else if (command == "set" && argc == 5)
+            request_direction(segment, argv[3], std::stoull(argv[4]));
+        else {
+            close_control_segment(segment);
+            return usage();
+        }
+        close_control_segment(segment);
+    } catch (const branch_changer_error& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    } catch (const std::logic_error&) {
+        return usage();
+    }
+    return 0;
+}